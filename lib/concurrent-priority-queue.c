@@ -0,0 +1,308 @@
+/**
+ * @file concurrent-priority-queue.c
+ * @brief Implementation of a concurrent priority queue using a min heap with
+ * one lock per node. Lower priority numbers will be dequeued first.
+ *
+ * The heap uses the same array layout as `PQ_pq` but stores nodes inline in
+ * lockable slots. A short global lock only hands out the position of the
+ * next or last element; all shifting is done with lock coupling on the
+ * slots, always locking a parent before its children so that no deadlock
+ * can occur. Positions are handed out in bit-reversed order within a
+ * level, so that consecutive inserts (and the deletes that undo them) walk
+ * through different subtrees and rarely contend on the same slots.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "./concurrent-priority-queue.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <sched.h>
+
+/**
+ * @brief Return the index in the heap array of the `n`-th element (counting
+ * from 1). Within a level, positions are filled in bit-reversed order, i.e.
+ * alternating between the left and right subtrees of every node.
+ *
+ * @param n The 1-based number of the element.
+ * @return int The 0-based index of the slot of the `n`-th element.
+ */
+int _bit_reversed_index(int n) {
+    int level = 31 - __builtin_clz((unsigned) n);
+    unsigned offset = (unsigned) n - (1u << level);
+    unsigned reversed = 0;
+    for (int b = 0; b < level; b++) {
+        reversed = (reversed << 1) | ((offset >> b) & 1u);
+    }
+    return (int) ((1u << level) | reversed) - 1;
+}
+
+/**
+ * @brief Swap the contents (tag and node) of two locked slots. The locks
+ * themselves stay in place.
+ *
+ * @param a One slot to swap.
+ * @param b Another slot to swap.
+ */
+static void _slot_swap(PQ_Slot * a, PQ_Slot * b) {
+    int tag = a->tag;
+    PQ_Node node = a->node;
+    a->tag = b->tag;
+    a->node = b->node;
+    b->tag = tag;
+    b->node = node;
+}
+
+static void _lock(PQ_concurrent_pq * q, int i) {
+    pthread_mutex_lock(&(q->heap[i].lock));
+}
+
+static void _unlock(PQ_concurrent_pq * q, int i) {
+    pthread_mutex_unlock(&(q->heap[i].lock));
+}
+
+/**
+ * @brief Create a concurrent priority queue able to hold `capacity`
+ * elements. Unlike `PQ_pq`, the heap cannot be resized as slots are
+ * locked individually while other threads walk the array.
+ *
+ * @param capacity The maximum amount of elements in the queue.
+ * @return PQ_concurrent_pq* A pointer to the created empty queue.
+ */
+PQ_concurrent_pq * PQ_concurrent_create(int capacity) {
+    // Bit-reversed positions may land anywhere in the last level, so the
+    // array always covers complete levels.
+    int slot_count = 1;
+    while (slot_count < capacity) slot_count = 2 * slot_count + 1;
+    PQ_concurrent_pq * q = malloc(sizeof(PQ_concurrent_pq));
+    PQ_Slot * slots = malloc(sizeof(PQ_Slot) * slot_count);
+    if (!q || !slots) {
+        perror("Error creating memory block for concurrent heap");
+        exit(1);
+    }
+    q->heap = slots;
+    pthread_mutex_init(&(q->size_lock), NULL);
+    for (int i = 0; i < slot_count; i++) {
+        pthread_mutex_init(&(q->heap[i].lock), NULL);
+        q->heap[i].tag = PQ_SLOT_EMPTY;
+    }
+    q->current_size = 0;
+    q->capacity = capacity;
+    q->slot_count = slot_count;
+    q->next_tag = 1;
+    return q;
+}
+
+/**
+ * @brief Destroy a `PQ_concurrent_pq`. No other thread may be using the
+ * queue.
+ *
+ * @param q A pointer to the queue to destroy.
+ */
+void PQ_concurrent_destroy(PQ_concurrent_pq * q) {
+    for (int i = 0; i < q->slot_count; i++) {
+        pthread_mutex_destroy(&(q->heap[i].lock));
+    }
+    pthread_mutex_destroy(&(q->size_lock));
+    free(q->heap);
+    free(q);
+}
+
+/**
+ * @brief Shifts the element inserted with `tag` at index `i` up the tree
+ * until the heap is satisfied. Only a parent and its child are locked at
+ * any time. The element may be moved up by a concurrent dequeue while it is
+ * unlocked, in which case it is followed to its parent.
+ *
+ * @param i The index at which the element was inserted.
+ * @param tag The tag of the insertion.
+ * @param q The queue being modified.
+ */
+void _concurrent_shift_up(int i, int tag, PQ_concurrent_pq * q) {
+    while (i > 0) {
+        int parent = _parent(i);
+        int old_i = i;
+        _lock(q, parent);
+        _lock(q, i);
+        PQ_Slot * p = &(q->heap[parent]);
+        PQ_Slot * c = &(q->heap[i]);
+        if (p->tag == PQ_SLOT_AVAILABLE && c->tag == tag) {
+            if (c->node.priority < p->node.priority) {
+                _slot_swap(p, c);
+                i = parent;
+            } else {
+                c->tag = PQ_SLOT_AVAILABLE;
+                i = -1;
+            }
+        } else if (p->tag == PQ_SLOT_EMPTY) {
+            // The element was taken by a dequeue; nothing is left to shift.
+            i = -1;
+        } else if (c->tag != tag) {
+            // The element was moved up by a dequeue.
+            i = parent;
+        }
+        _unlock(q, old_i);
+        _unlock(q, parent);
+        // The parent is still being inserted: let its thread make progress.
+        if (i == old_i) sched_yield();
+    }
+    if (i == 0) {
+        _lock(q, 0);
+        if (q->heap[0].tag == tag) q->heap[0].tag = PQ_SLOT_AVAILABLE;
+        _unlock(q, 0);
+    }
+}
+
+/**
+ * @brief Shifts the element at the locked index `i` down the tree until the
+ * heap is satisfied, coupling the locks of a parent and its children. The
+ * last locked slot is released before returning.
+ *
+ * @param i The locked index to start from.
+ * @param q The queue being modified.
+ */
+void _concurrent_shift_down(int i, PQ_concurrent_pq * q) {
+    while (_right_child(i) < q->slot_count) {
+        int l = _left_child(i);
+        int r = _right_child(i);
+        int child;
+        _lock(q, l);
+        _lock(q, r);
+        if (q->heap[l].tag == PQ_SLOT_EMPTY) {
+            _unlock(q, r);
+            _unlock(q, l);
+            break;
+        } else if (q->heap[r].tag == PQ_SLOT_EMPTY
+                   || q->heap[l].node.priority < q->heap[r].node.priority) {
+            _unlock(q, r);
+            child = l;
+        } else {
+            _unlock(q, l);
+            child = r;
+        }
+        if (q->heap[child].node.priority < q->heap[i].node.priority) {
+            _slot_swap(&(q->heap[child]), &(q->heap[i]));
+            _unlock(q, i);
+            i = child;
+        } else {
+            _unlock(q, child);
+            break;
+        }
+    }
+    _unlock(q, i);
+}
+
+/**
+ * @brief Enqueue an element with `data` and `priority` into the provided
+ * queue `q`. Safe to call from any thread.
+ *
+ * @param q The queue to which the value will be added.
+ * @param data The data to add to the new node in `q`.
+ * @param priority The priority of the data to add to the new node in `q`.
+ * @return int 1 if the element was added, 0 if the queue is full.
+ */
+int PQ_concurrent_enqueue(PQ_concurrent_pq * q, int data, int priority) {
+    pthread_mutex_lock(&(q->size_lock));
+    if (q->current_size == q->capacity) {
+        pthread_mutex_unlock(&(q->size_lock));
+        return 0;
+    }
+    q->current_size = q->current_size + 1;
+    int i = _bit_reversed_index(q->current_size);
+    int tag = q->next_tag;
+    q->next_tag = q->next_tag == INT_MAX ? 1 : q->next_tag + 1;
+    _lock(q, i);
+    pthread_mutex_unlock(&(q->size_lock));
+    q->heap[i].node.data = data;
+    q->heap[i].node.priority = priority;
+    q->heap[i].tag = tag;
+    _unlock(q, i);
+    _concurrent_shift_up(i, tag, q);
+    return 1;
+}
+
+/**
+ * @brief A helper function which dequeues the node with the highest priority
+ * into `out`. Safe to call from any thread.
+ *
+ * @param q The queue from which a node will be dequeued.
+ * @param out Where the dequeued node is copied.
+ * @return int 1 if a node was dequeued, 0 if the queue is empty.
+ */
+int _PQ_concurrent_dequeue(PQ_concurrent_pq * q, PQ_Node * out) {
+    pthread_mutex_lock(&(q->size_lock));
+    if (q->current_size == 0) {
+        pthread_mutex_unlock(&(q->size_lock));
+        return 0;
+    }
+    int bottom = _bit_reversed_index(q->current_size);
+    q->current_size = q->current_size - 1;
+    _lock(q, bottom);
+    pthread_mutex_unlock(&(q->size_lock));
+    PQ_Node last = q->heap[bottom].node;
+    q->heap[bottom].tag = PQ_SLOT_EMPTY;
+    _unlock(q, bottom);
+    _lock(q, 0);
+    if (q->heap[0].tag == PQ_SLOT_EMPTY) {
+        // The last element was the root.
+        _unlock(q, 0);
+        *out = last;
+        return 1;
+    }
+    // Replace the root with the last element and shift it down.
+    *out = q->heap[0].node;
+    q->heap[0].node = last;
+    q->heap[0].tag = PQ_SLOT_AVAILABLE;
+    _concurrent_shift_down(0, q);
+    return 1;
+}
+
+/**
+ * @brief Dequeue the data of the element with the highest priority.
+ *
+ * @param q The queue from which the element will be dequeued.
+ * @param data Where the data of the dequeued element is stored.
+ * @return int 1 if an element was dequeued, 0 if the queue is empty.
+ */
+int PQ_concurrent_dequeue(PQ_concurrent_pq * q, int * data) {
+    PQ_Node node;
+    if (!_PQ_concurrent_dequeue(q, &node)) return 0;
+    *data = node.data;
+    return 1;
+}
+
+/**
+ * @brief Get the data of the element with the highest priority without
+ * removing it from `q`.
+ *
+ * @param q The queue to search.
+ * @param data Where the data of the element is stored.
+ * @return int 1 if the queue had an element, 0 if it is empty.
+ */
+int PQ_concurrent_peek(PQ_concurrent_pq * q, int * data) {
+    int found = 0;
+    _lock(q, 0);
+    if (q->heap[0].tag != PQ_SLOT_EMPTY) {
+        *data = q->heap[0].node.data;
+        found = 1;
+    }
+    _unlock(q, 0);
+    return found;
+}
+
+/**
+ * @brief Get the amount of elements in the queue.
+ *
+ * @param q The queue to measure.
+ * @return int The amount of elements in `q`.
+ */
+int PQ_concurrent_size(PQ_concurrent_pq * q) {
+    pthread_mutex_lock(&(q->size_lock));
+    int size = q->current_size;
+    pthread_mutex_unlock(&(q->size_lock));
+    return size;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file concurrent-priority-queue.h
+ * @brief Type definitions for the concurrent priority queue. This is a
+ * strictly ordered min heap protected by one lock per node (Hunt et al.,
+ * "An Efficient Algorithm for Concurrent Priority Queue Heaps").
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef CONCURRENT_PRIORITY_QUEUE_H
+#define CONCURRENT_PRIORITY_QUEUE_H
+
+#include "./priority-queue.h"
+#include <pthread.h>
+
+/* Tag of a slot which does not hold an element.                  */
+#define PQ_SLOT_EMPTY -1
+/* Tag of a slot whose element is settled in the heap.            */
+#define PQ_SLOT_AVAILABLE -2
+
+/**
+ * A slot of the heap. Any other (positive) tag is the id of the insertion
+ * which is still shifting the element up the tree.
+ */
+struct pq_slot {
+    pthread_mutex_t lock;
+    int tag;
+    PQ_Node node;
+};
+
+typedef struct pq_slot PQ_Slot;
+
+struct PQ_concurrent_pq {
+    /* Protects `current_size` and `next_tag` only, never the slots. */
+    pthread_mutex_t size_lock;
+    int current_size;
+    int capacity;
+    /* Always a complete tree (2^k - 1 slots) of at least `capacity`. */
+    int slot_count;
+    int next_tag;
+    PQ_Slot * heap;
+};
+
+typedef struct PQ_concurrent_pq PQ_concurrent_pq;
+
+PQ_concurrent_pq * PQ_concurrent_create(int capacity);
+void PQ_concurrent_destroy(PQ_concurrent_pq * q);
+int PQ_concurrent_enqueue(PQ_concurrent_pq * q, int data, int priority);
+int PQ_concurrent_dequeue(PQ_concurrent_pq * q, int * data);
+int PQ_concurrent_peek(PQ_concurrent_pq * q, int * data);
+int PQ_concurrent_size(PQ_concurrent_pq * q);
+int _PQ_concurrent_dequeue(PQ_concurrent_pq * q, PQ_Node * out);
+int _bit_reversed_index(int n);
+
+#endif
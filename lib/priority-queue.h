@@ -9,6 +9,9 @@
  * 
  */
 
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
 /* The initial size of the PQ on creation.           */
 #define PQ_INITIAL_SIZE 10
 /* The size of the increments of the priority queue. */
@@ -41,4 +44,9 @@ PQ_Node * _PQ_dequeue(PQ_pq* q);
 void PQ_destroy_heap_nodes(PQ_Node ** heap, int heap_size);
 void _swap(PQ_Node** a, PQ_Node** b);
 PQ_Node * _node_copy(PQ_Node * a);
+int _parent(int i);
+int _left_child(int i);
+int _right_child(int i);
+
+#endif
 
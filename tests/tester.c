@@ -9,6 +9,7 @@
  * 
  */
 #include "../lib/priority-queue.h"
+#include "../lib/concurrent-priority-queue.h"
 #include <CUnit/CUnit.h>
 #include <CUnit/Basic.h>
 #include <stdlib.h>
@@ -17,6 +18,7 @@
 #include <regex.h>
 #include <unistd.h>
 #include <assert.h>
+#include <pthread.h>
 #define RANDOM_NUM_SIZE 4294967296
 
 struct _random_pq {
@@ -337,6 +339,101 @@ int test_swap(void) {
     }
 }
 
+/**
+ * @brief Test that the concurrent queue dequeues in order when used by a
+ * single thread, and refuses elements once full.
+ *
+ * @return int 0 if fail, 1 if pass.
+ */
+int test_concurrent_order(void) {
+    const int SIZE = 100;
+    _Random_pq * r_pq = _random_n_pq(SIZE);
+    PQ_concurrent_pq * cq = PQ_concurrent_create(SIZE);
+    for (int i = 0; i < SIZE; i++) {
+        CU_ASSERT(PQ_concurrent_enqueue(cq, r_pq->nodes_random[i]->data, r_pq->nodes_random[i]->priority));
+    }
+    CU_ASSERT_FALSE(PQ_concurrent_enqueue(cq, 0, 0));
+    for (int i = 0; i < SIZE; i++) {
+        PQ_Node node;
+        CU_ASSERT(_PQ_concurrent_dequeue(cq, &node));
+        CU_ASSERT(_compare_single_nodes(&node, r_pq->nodes_ordered[i]));
+    }
+    int data;
+    CU_ASSERT_FALSE(PQ_concurrent_dequeue(cq, &data));
+    PQ_concurrent_destroy(cq);
+    _destroy_random_pq(r_pq);
+}
+
+#define CONCURRENT_THREADS 4
+#define CONCURRENT_PER_THREAD 2000
+
+struct _concurrent_worker {
+    PQ_concurrent_pq * cq;
+    int id;
+    int * seen;
+};
+
+void * _concurrent_enqueue_worker(void * arg) {
+    struct _concurrent_worker * w = arg;
+    for (int i = 0; i < CONCURRENT_PER_THREAD; i++) {
+        int priority = i * CONCURRENT_THREADS + w->id;
+        PQ_concurrent_enqueue(w->cq, priority, priority);
+    }
+    return NULL;
+}
+
+void * _concurrent_dequeue_worker(void * arg) {
+    struct _concurrent_worker * w = arg;
+    int data;
+    for (int i = 0; i < CONCURRENT_PER_THREAD / 2; i++) {
+        if (!PQ_concurrent_dequeue(w->cq, &data)) break;
+        __atomic_fetch_add(&(w->seen[data]), 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Enqueue and then dequeue from several threads at once. Every element
+ * must come out exactly once, and the heap must still be valid once the
+ * threads are done.
+ *
+ * @return int 0 if fail, 1 if pass.
+ */
+int test_concurrent_threads(void) {
+    const int TOTAL = CONCURRENT_THREADS * CONCURRENT_PER_THREAD;
+    PQ_concurrent_pq * cq = PQ_concurrent_create(TOTAL);
+    int * seen = calloc(TOTAL, sizeof(int));
+    pthread_t threads[CONCURRENT_THREADS];
+    struct _concurrent_worker workers[CONCURRENT_THREADS];
+    for (int i = 0; i < CONCURRENT_THREADS; i++) {
+        workers[i].cq = cq;
+        workers[i].id = i;
+        workers[i].seen = seen;
+        pthread_create(&threads[i], NULL, _concurrent_enqueue_worker, &workers[i]);
+    }
+    for (int i = 0; i < CONCURRENT_THREADS; i++) pthread_join(threads[i], NULL);
+    CU_ASSERT(PQ_concurrent_size(cq) == TOTAL);
+    for (int i = 0; i < CONCURRENT_THREADS; i++) {
+        pthread_create(&threads[i], NULL, _concurrent_dequeue_worker, &workers[i]);
+    }
+    for (int i = 0; i < CONCURRENT_THREADS; i++) pthread_join(threads[i], NULL);
+    CU_ASSERT(PQ_concurrent_size(cq) == TOTAL / 2);
+    int data, last = -1, ordered = 1;
+    while (PQ_concurrent_dequeue(cq, &data)) {
+        if (data < last) ordered = 0;
+        last = data;
+        seen[data]++;
+    }
+    CU_ASSERT(ordered);
+    int all_once = 1;
+    for (int i = 0; i < TOTAL; i++) {
+        if (seen[i] != 1) all_once = 0;
+    }
+    CU_ASSERT(all_once);
+    free(seen);
+    PQ_concurrent_destroy(cq);
+}
+
 int main() {
     /* Seed randomness */
     time_t t;
@@ -351,6 +448,9 @@ int main() {
     CU_add_test(suite, "Larger test for dequeuing and resizing", (void*) test_large);
     CU_add_test(suite, "Test high level dequeing interface", (void*) test_high_level_dequeue);
     CU_add_test(suite, "Test peeking for dequeue", (void*) test_peek);
+    CU_pSuite concurrent = CU_add_suite("concurrent tests", NULL, NULL);
+    CU_add_test(concurrent, "Concurrent queue ordering", (void*) test_concurrent_order);
+    CU_add_test(concurrent, "Concurrent enqueue and dequeue", (void*) test_concurrent_threads);
 
     CU_basic_run_tests();
     CU_cleanup_registry();